@@ -0,0 +1,73 @@
+#ifndef RANDOMNESS_TESTER_H
+#define RANDOMNESS_TESTER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct RandomnessTestConfig {
+    double alpha = 0.01;           // Significance level
+    size_t block_size = 128;       // Block length for block-based tests
+    size_t template_length = 9;    // Template length for template matching tests
+    size_t linear_complexity_block_size = 500;  // M for the linear complexity test (500..5000)
+};
+
+struct RandomnessTestResult {
+    double frequency_pvalue = 0.0;
+    bool frequency_test_passed = false;
+    double runs_pvalue = 0.0;
+    bool runs_test_passed = false;
+    double chi_square_pvalue = 0.0;
+    bool chi_square_test_passed = false;
+    double linear_complexity_pvalue = 0.0;
+    bool linear_complexity_test_passed = false;
+    double matrix_rank_pvalue = 0.0;
+    bool matrix_rank_test_passed = false;
+    double spectral_pvalue = 0.0;  // Covers only the longest power-of-two prefix
+    bool spectral_test_passed = false;
+};
+
+class RandomnessTester {
+public:
+    RandomnessTester() = default;
+    explicit RandomnessTester(const RandomnessTestConfig& config);
+
+    // Run all tests and compare each p-value against alpha
+    RandomnessTestResult test(const std::vector<uint8_t>& bits) const;
+
+    // Statistical tests (each returns a p-value)
+    double frequency_test(const std::vector<uint8_t>& bits) const;
+    double runs_test(const std::vector<uint8_t>& bits) const;
+    double chi_square_test(const std::vector<uint8_t>& bits) const;
+
+    // NIST SP 800-22 section 2.10: Berlekamp-Massey over blocks of M bits
+    double linear_complexity_test(const std::vector<uint8_t>& bits) const;
+    // NIST SP 800-22 section 2.5: rank of disjoint 32x32 binary matrices
+    double matrix_rank_test(const std::vector<uint8_t>& bits) const;
+    // NIST SP 800-22 section 2.6: discrete Fourier transform (spectral) test.
+    // Only the longest power-of-two prefix of `bits` is examined (the FFT is
+    // radix-2), so up to half of the input can be ignored; pass a power-of-two
+    // length to have every bit tested. Returns 0.0 if that prefix is < 1000 bits.
+    double spectral_test(const std::vector<uint8_t>& bits) const;
+
+    // Linear complexity (shortest LFSR length) of a bit sequence
+    static size_t linear_complexity(const std::vector<uint8_t>& bits);
+
+    // |X[k]|^2 for k < n/2, where X is the DFT of the +/-1 mapped sequence.
+    // The length must be a power of two.
+    static std::vector<double> power_spectrum(const std::vector<uint8_t>& bits);
+
+    static double calculate_shannon_entropy(const std::vector<uint8_t>& bits);
+    static double calculate_min_entropy(const std::vector<uint8_t>& bits);
+
+    // Upper-tail probability of a chi-square statistic
+    double calculate_p_value(double chi_square, size_t degrees_of_freedom) const;
+
+private:
+    double normal_cdf(double x) const;
+    double erfc(double x) const;
+
+    RandomnessTestConfig config_;
+};
+
+#endif // RANDOMNESS_TESTER_H
@@ -3,6 +3,375 @@
 #include <numeric>
 #include <algorithm>
 #include <stdexcept>
+#include <complex>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Pack one bit per byte into 64-bit words, LSB first (bit i -> word i/64, bit i%64)
+std::vector<uint64_t> pack_bits(const std::vector<uint8_t>& bits) {
+    std::vector<uint64_t> words((bits.size() + 63) / 64, 0);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        words[i >> 6] |= static_cast<uint64_t>(bits[i] & 1) << (i & 63);
+    }
+    return words;
+}
+
+inline uint64_t bit_at(const std::vector<uint64_t>& words, size_t pos) {
+    return (words[pos >> 6] >> (pos & 63)) & 1;
+}
+
+inline uint64_t parity64(uint64_t x) {
+    x ^= x >> 32;
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+}
+
+// Multiply a packed GF(2) polynomial by x, feeding `in` into the constant term
+inline void shift_left_one(uint64_t* words, size_t count, uint64_t in) {
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t out = words[i] >> 63;
+        words[i] = (words[i] << 1) | in;
+        in = out;
+    }
+}
+
+// Scratch buffers reused across blocks so the linear complexity test does not
+// allocate once per block
+struct BerlekampMasseyScratch {
+    std::vector<uint64_t> c;  // Connection polynomial C(x)
+    std::vector<uint64_t> b;  // Previous C(x), pre-multiplied by x^(N - m)
+    std::vector<uint64_t> r;  // Window s[N], s[N-1], ... so that bit i holds s[N-i]
+    std::vector<uint64_t> t;
+};
+
+// Berlekamp-Massey over GF(2) on `length` bits starting at `offset`.
+// All polynomials are packed 64 coefficients per word, so the discrepancy is
+// the parity of (C & R) and the update C ^= B * x^(N-m) is a word-wide XOR.
+// Only the words that can hold non-zero coefficients at step N are touched.
+size_t berlekamp_massey(const std::vector<uint64_t>& seq, size_t offset, size_t length,
+                        BerlekampMasseyScratch& scratch) {
+    // deg C <= L <= length and deg B * x^(N-m) <= N + 1
+    const size_t words = (length + 2) / 64 + 1;
+    scratch.c.assign(words, 0);
+    scratch.b.assign(words, 0);
+    scratch.r.assign(words, 0);
+    scratch.t.resize(words);
+    uint64_t* c = scratch.c.data();
+    uint64_t* b = scratch.b.data();
+    uint64_t* r = scratch.r.data();
+    uint64_t* t = scratch.t.data();
+
+    c[0] = 1;  // C(x) = 1
+    b[0] = 2;  // B(x) = 1 with m = -1, so B * x^(N-m) = x at N = 0
+    size_t complexity = 0;
+
+    for (size_t n = 0; n < length; ++n) {
+        const size_t active = std::min(words, ((n + 2) >> 6) + 1);
+        shift_left_one(r, active, bit_at(seq, offset + n));
+
+        uint64_t acc = 0;
+        for (size_t i = 0; i < active; ++i) {
+            acc ^= c[i] & r[i];
+        }
+
+        if (parity64(acc)) {
+            if (2 * complexity <= n) {
+                std::copy(c, c + active, t);
+                for (size_t i = 0; i < active; ++i) {
+                    c[i] ^= b[i];
+                }
+                complexity = n + 1 - complexity;
+                std::copy(t, t + active, b);
+            } else {
+                for (size_t i = 0; i < active; ++i) {
+                    c[i] ^= b[i];
+                }
+            }
+        }
+        shift_left_one(b, active, 0);
+    }
+
+    return complexity;
+}
+
+// Rank over GF(2) of a 32x32 matrix stored one row per word
+size_t binary_rank(uint32_t rows[32]) {
+    size_t rank = 0;
+    for (unsigned col = 0; col < 32 && rank < 32; ++col) {
+        const uint32_t mask = 1u << col;
+        size_t pivot = rank;
+        while (pivot < 32 && !(rows[pivot] & mask)) {
+            ++pivot;
+        }
+        if (pivot == 32) {
+            continue;
+        }
+        std::swap(rows[rank], rows[pivot]);
+        for (size_t i = rank + 1; i < 32; ++i) {
+            rows[i] ^= rows[rank] & (0u - ((rows[i] >> col) & 1u));
+        }
+        ++rank;
+    }
+    return rank;
+}
+
+using Complex = std::complex<double>;
+
+// Plain complex multiply; std::complex operator* carries NaN/Inf recovery
+// that is far slower than the arithmetic itself in the FFT inner loop
+inline Complex cmul(const Complex& a, const Complex& b) {
+    return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+// exp(-2*pi*i*k/size) for any k < size from two tables of about sqrt(size)
+// entries each, so very long transforms do not need a size/2 twiddle array
+class TwiddleTable {
+public:
+    explicit TwiddleTable(size_t size) {
+        size_t log_size = 0;
+        while ((size_t{1} << log_size) < size) {
+            ++log_size;
+        }
+        shift_ = log_size / 2;
+        mask_ = (size_t{1} << shift_) - 1;
+        const double step = -2.0 * kPi / static_cast<double>(size);
+        lo_.resize(size_t{1} << shift_);
+        hi_.resize((size >> shift_) + 1);
+        for (size_t j = 0; j < lo_.size(); ++j) {
+            lo_[j] = std::polar(1.0, step * static_cast<double>(j));
+        }
+        for (size_t j = 0; j < hi_.size(); ++j) {
+            hi_[j] = std::polar(1.0, step * static_cast<double>(j << shift_));
+        }
+    }
+
+    Complex operator()(size_t k) const {
+        return cmul(hi_[k >> shift_], lo_[k & mask_]);
+    }
+
+private:
+    size_t shift_ = 0;
+    size_t mask_ = 0;
+    std::vector<Complex> lo_;
+    std::vector<Complex> hi_;
+};
+
+// Sub-transforms at or below this many points (128 KiB of data) are finished
+// entirely in cache before moving on to the next one
+constexpr size_t kFftBlock = size_t{1} << 13;
+
+// Bit reversal permutes 2^kTileBits x 2^kTileBits tiles at a time so that both
+// the reads and the scattered writes stay within a few KiB
+constexpr size_t kTileBits = 5;
+
+inline size_t reverse_bits(size_t value, size_t bits) {
+    size_t result = 0;
+    for (size_t i = 0; i < bits; ++i) {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+// Radix-2 decimation-in-frequency FFT. Stages wider than kFftBlock are fused
+// in pairs (radix-2^2) and done as streaming passes over the array; once a
+// sub-transform fits in cache all of its remaining stages run there, using a
+// contiguous per-stage twiddle table instead of strided lookups. The
+// bit-reversed output is then put back in natural order tile by tile.
+class BlockedFft {
+public:
+    explicit BlockedFft(size_t size)
+        : size_(size), twiddle_(size), block_twiddle_(std::min(size, kFftBlock)) {
+        while ((size_t{1} << log_size_) < size_) {
+            ++log_size_;
+        }
+        // block_twiddle_[s/2 + j] = exp(-2*pi*i*j/s) for each span s <= kFftBlock
+        for (size_t span = 2; span <= block_twiddle_.size(); span <<= 1) {
+            const size_t stride = size_ / span;
+            for (size_t j = 0; j < span / 2; ++j) {
+                block_twiddle_[span / 2 + j] = twiddle_(j * stride);
+            }
+        }
+    }
+
+    void transform(Complex* data) const {
+        transform(data, size_);
+        bit_reverse(data);
+    }
+
+private:
+    void transform(Complex* data, size_t len) const {
+        if (len <= kFftBlock) {
+            transform_block(data, len);
+            return;
+        }
+        if (len / 2 <= kFftBlock) {
+            radix2_pass(data, len);
+            transform_block(data, len / 2);
+            transform_block(data + len / 2, len / 2);
+            return;
+        }
+        radix4_pass(data, len);
+        const size_t quarter = len / 4;
+        for (size_t i = 0; i < 4; ++i) {
+            transform(data + i * quarter, quarter);
+        }
+    }
+
+    void radix2_pass(Complex* data, size_t len) const {
+        const size_t half = len / 2;
+        const size_t stride = size_ / len;
+        for (size_t j = 0; j < half; ++j) {
+            const Complex u = data[j];
+            const Complex v = data[j + half];
+            data[j] = u + v;
+            data[j + half] = cmul(u - v, twiddle_(j * stride));
+        }
+    }
+
+    // The span-len and span-len/2 stages in a single pass over the data
+    void radix4_pass(Complex* data, size_t len) const {
+        const size_t quarter = len / 4;
+        const size_t stride = size_ / len;
+        Complex* d0 = data;
+        Complex* d1 = data + quarter;
+        Complex* d2 = data + 2 * quarter;
+        Complex* d3 = data + 3 * quarter;
+        for (size_t j = 0; j < quarter; ++j) {
+            const Complex w1 = twiddle_(j * stride);
+            const Complex w2 = twiddle_(2 * j * stride);
+            // exp(-2*pi*i*(j + len/4)/len) = -i * w1
+            const Complex w3(w1.imag(), -w1.real());
+
+            const Complex a0 = d0[j], a1 = d1[j], a2 = d2[j], a3 = d3[j];
+            const Complex b0 = a0 + a2;
+            const Complex b1 = a1 + a3;
+            const Complex b2 = cmul(a0 - a2, w1);
+            const Complex b3 = cmul(a1 - a3, w3);
+
+            d0[j] = b0 + b1;
+            d1[j] = cmul(b0 - b1, w2);
+            d2[j] = b2 + b3;
+            d3[j] = cmul(b2 - b3, w2);
+        }
+    }
+
+    void transform_block(Complex* data, size_t len) const {
+        for (size_t span = len; span >= 2; span >>= 1) {
+            const size_t half = span / 2;
+            const Complex* w = block_twiddle_.data() + half;
+            for (size_t base = 0; base < len; base += span) {
+                Complex* lo = data + base;
+                Complex* hi = lo + half;
+                for (size_t j = 0; j < half; ++j) {
+                    const Complex u = lo[j];
+                    const Complex v = hi[j];
+                    lo[j] = u + v;
+                    hi[j] = cmul(u - v, w[j]);
+                }
+            }
+        }
+    }
+
+    void bit_reverse(Complex* data) const {
+        if (log_size_ < 2 * kTileBits) {
+            for (size_t i = 1, j = 0; i < size_; ++i) {
+                size_t bit = size_ >> 1;
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+                if (i < j) {
+                    std::swap(data[i], data[j]);
+                }
+            }
+            return;
+        }
+
+        // Index = (high, middle, low) with kTileBits-wide high and low parts.
+        // Reversal maps the tile of all (high, low) at `middle` onto the tile
+        // at reverse(middle), transposing and reversing within the tile.
+        constexpr size_t tile = size_t{1} << kTileBits;
+        const size_t middle_bits = log_size_ - 2 * kTileBits;
+        const size_t high_shift = middle_bits + kTileBits;
+        size_t reverse_tile[tile];
+        for (size_t i = 0; i < tile; ++i) {
+            reverse_tile[i] = reverse_bits(i, kTileBits);
+        }
+
+        std::vector<Complex> first(tile * tile);
+        std::vector<Complex> second(tile * tile);
+        auto gather = [&](size_t middle, Complex* buffer) {
+            for (size_t high = 0; high < tile; ++high) {
+                const Complex* row = data + (high << high_shift) + (middle << kTileBits);
+                std::copy(row, row + tile, buffer + high * tile);
+            }
+        };
+        auto scatter = [&](size_t middle, const Complex* buffer) {
+            for (size_t low = 0; low < tile; ++low) {
+                Complex* row = data + (reverse_tile[low] << high_shift) + (middle << kTileBits);
+                for (size_t high = 0; high < tile; ++high) {
+                    row[reverse_tile[high]] = buffer[high * tile + low];
+                }
+            }
+        };
+
+        for (size_t middle = 0; middle < (size_t{1} << middle_bits); ++middle) {
+            const size_t partner = reverse_bits(middle, middle_bits);
+            if (partner < middle) {
+                continue;
+            }
+            gather(middle, first.data());
+            if (partner != middle) {
+                gather(partner, second.data());
+                scatter(middle, second.data());
+            }
+            scatter(partner, first.data());
+        }
+    }
+
+    size_t size_;
+    size_t log_size_ = 0;
+    TwiddleTable twiddle_;
+    std::vector<Complex> block_twiddle_;
+};
+
+// Calls visit(|X[k]|^2) for k < n/2 in order, where X is the DFT of the n-point
+// +/-1 sequence built from `words`. The real input is packed as n/2 complex
+// points (even bits in the real part, odd bits in the imaginary part),
+// transformed once, and then split into the spectrum of the real sequence, so
+// the only scratch is the n/2-point complex buffer.
+template <typename Visitor>
+void visit_power_spectrum(const std::vector<uint64_t>& words, size_t n, Visitor&& visit) {
+    const size_t half = n / 2;
+    std::vector<Complex> z(half);
+    for (size_t k = 0; k < half; ++k) {
+        z[k] = Complex(2.0 * bit_at(words, 2 * k) - 1.0,
+                       2.0 * bit_at(words, 2 * k + 1) - 1.0);
+    }
+
+    BlockedFft(half).transform(z.data());
+
+    // X[k] = E[k] + W_n^k * O[k] with E = (Z[k] + conj(Z[-k])) / 2 and
+    // O = (Z[k] - conj(Z[-k])) / 2i
+    const TwiddleTable twiddle(n);
+    for (size_t k = 0; k < half; ++k) {
+        const Complex zk = z[k];
+        const Complex zn = std::conj(z[(half - k) & (half - 1)]);
+        const Complex even = 0.5 * (zk + zn);
+        const Complex diff = 0.5 * (zk - zn);
+        const Complex odd(diff.imag(), -diff.real());
+        visit(std::norm(even + cmul(twiddle(k), odd)));
+    }
+}
+
+} // namespace
 
 RandomnessTester::RandomnessTester(const RandomnessTestConfig& config) 
     : config_(config) {
@@ -16,6 +385,9 @@ RandomnessTester::RandomnessTester(const RandomnessTestConfig& config)
     if (config_.template_length < 2) {
         throw std::invalid_argument("Template length must be at least 2");
     }
+    if (config_.linear_complexity_block_size < 500 || config_.linear_complexity_block_size > 5000) {
+        throw std::invalid_argument("Linear complexity block size must be between 500 and 5000");
+    }
 }
 
 RandomnessTestResult RandomnessTester::test(const std::vector<uint8_t>& bits) const {
@@ -31,6 +403,15 @@ RandomnessTestResult RandomnessTester::test(const std::vector<uint8_t>& bits) co
     result.chi_square_pvalue = chi_square_test(bits);
     result.chi_square_test_passed = (result.chi_square_pvalue >= config_.alpha);
     
+    result.linear_complexity_pvalue = linear_complexity_test(bits);
+    result.linear_complexity_test_passed = (result.linear_complexity_pvalue >= config_.alpha);
+    
+    result.matrix_rank_pvalue = matrix_rank_test(bits);
+    result.matrix_rank_test_passed = (result.matrix_rank_pvalue >= config_.alpha);
+    
+    result.spectral_pvalue = spectral_test(bits);
+    result.spectral_test_passed = (result.spectral_pvalue >= config_.alpha);
+    
     return result;
 }
 
@@ -119,6 +500,130 @@ double RandomnessTester::chi_square_test(const std::vector<uint8_t>& bits) const
     return p_value;
 }
 
+double RandomnessTester::linear_complexity_test(const std::vector<uint8_t>& bits) const {
+    const size_t M = config_.linear_complexity_block_size;
+    const size_t N = bits.size() / M;
+    if (N < 200) {
+        return 0.0;  // SP 800-22 requires at least 200 blocks for the chi-square to hold
+    }
+    
+    // Theoretical mean of the linear complexity of a random M-bit block
+    const double sign = (M % 2 == 0) ? 1.0 : -1.0;  // (-1)^M
+    const double mu = M / 2.0 + (9.0 - sign) / 36.0
+                    - (M / 3.0 + 2.0 / 9.0) / std::pow(2.0, static_cast<double>(M));
+    
+    // Bucket T = (-1)^M * (L - mu) + 2/9 into the seven SP 800-22 classes
+    size_t counts[7] = {0, 0, 0, 0, 0, 0, 0};
+    const std::vector<uint64_t> packed = pack_bits(bits);
+    BerlekampMasseyScratch scratch;
+    for (size_t block = 0; block < N; ++block) {
+        const size_t L = berlekamp_massey(packed, block * M, M, scratch);
+        const double T = sign * (L - mu) + 2.0 / 9.0;
+        
+        size_t bucket = 6;
+        if (T <= -2.5) bucket = 0;
+        else if (T <= -1.5) bucket = 1;
+        else if (T <= -0.5) bucket = 2;
+        else if (T <= 0.5) bucket = 3;
+        else if (T <= 1.5) bucket = 4;
+        else if (T <= 2.5) bucket = 5;
+        ++counts[bucket];
+    }
+    
+    static const double pi[7] = {0.010417, 0.03125, 0.125, 0.5, 0.25, 0.0625, 0.020833};
+    double chi_square = 0.0;
+    for (int i = 0; i < 7; ++i) {
+        const double expected = N * pi[i];
+        const double diff = counts[i] - expected;
+        chi_square += (diff * diff) / expected;
+    }
+    
+    // Degrees of freedom = number of classes - 1 = 6
+    return calculate_p_value(chi_square, 6);
+}
+
+double RandomnessTester::matrix_rank_test(const std::vector<uint8_t>& bits) const {
+    constexpr size_t kMatrixBits = 32 * 32;
+    const size_t N = bits.size() / kMatrixBits;
+    if (N < 38) {
+        return 0.0;  // SP 800-22 requires at least 38 matrices
+    }
+    
+    // Each 32-bit row sits in one half of a packed word; rows are stored with
+    // their columns reversed, which does not change the rank
+    const std::vector<uint64_t> packed = pack_bits(bits);
+    size_t full_rank = 0;
+    size_t full_rank_minus_one = 0;
+    uint32_t rows[32];
+    for (size_t m = 0; m < N; ++m) {
+        const uint64_t* matrix = packed.data() + m * (kMatrixBits / 64);
+        for (size_t r = 0; r < 32; ++r) {
+            rows[r] = static_cast<uint32_t>(matrix[r / 2] >> ((r % 2) * 32));
+        }
+        
+        const size_t rank = binary_rank(rows);
+        if (rank == 32) ++full_rank;
+        else if (rank == 31) ++full_rank_minus_one;
+    }
+    
+    // Probabilities of rank 32, 31 and <= 30 for a random 32x32 binary matrix
+    const double observed[3] = {
+        static_cast<double>(full_rank),
+        static_cast<double>(full_rank_minus_one),
+        static_cast<double>(N - full_rank - full_rank_minus_one)
+    };
+    static const double p[3] = {0.2888, 0.5776, 0.1336};
+    double chi_square = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        const double expected = N * p[i];
+        const double diff = observed[i] - expected;
+        chi_square += (diff * diff) / expected;
+    }
+    
+    // Degrees of freedom = number of classes - 1 = 2
+    return calculate_p_value(chi_square, 2);
+}
+
+double RandomnessTester::spectral_test(const std::vector<uint8_t>& bits) const {
+    // The in-house FFT is radix-2, so test the longest power-of-two prefix
+    size_t n = 1;
+    while (n * 2 <= bits.size()) {
+        n *= 2;
+    }
+    if (n < 1000) {
+        return 0.0;  // SP 800-22 recommends at least 1000 bits
+    }
+    
+    // Count peaks below the 95% threshold T = sqrt(ln(1/0.05) * n)
+    const double threshold_sq = std::log(1.0 / 0.05) * n;
+    size_t below = 0;
+    visit_power_spectrum(pack_bits(bits), n, [&below, threshold_sq](double power) {
+        below += (power < threshold_sq);
+    });
+    
+    const double expected = 0.95 * n / 2.0;
+    const double d = (below - expected) / std::sqrt(n * 0.95 * 0.05 / 4.0);
+    
+    return erfc(std::abs(d) / std::sqrt(2.0));
+}
+
+std::vector<double> RandomnessTester::power_spectrum(const std::vector<uint8_t>& bits) {
+    const size_t n = bits.size();
+    if (n < 2 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("Power spectrum length must be a power of two");
+    }
+    
+    std::vector<double> power;
+    power.reserve(n / 2);
+    visit_power_spectrum(pack_bits(bits), n, [&power](double p) { power.push_back(p); });
+    return power;
+}
+
+size_t RandomnessTester::linear_complexity(const std::vector<uint8_t>& bits) {
+    BerlekampMasseyScratch scratch;
+    return berlekamp_massey(pack_bits(bits), 0, bits.size(), scratch);
+}
+
 double RandomnessTester::calculate_shannon_entropy(const std::vector<uint8_t>& bits) {
     if (bits.empty()) {
         return 0.0;
@@ -151,14 +656,30 @@ double RandomnessTester::calculate_min_entropy(const std::vector<uint8_t>& bits)
 }
 
 double RandomnessTester::calculate_p_value(double chi_square, size_t degrees_of_freedom) const {
-    // For degrees of freedom = 1, we can use the complementary error function
-    if (degrees_of_freedom == 1) {
-        return erfc(std::sqrt(chi_square / 2.0));
+    // p = Q(k/2, x/2), the regularized upper incomplete gamma function, which
+    // has a closed form for every integer number of degrees of freedom
+    const double x = chi_square / 2.0;
+    const size_t half_dof = degrees_of_freedom / 2;
+    
+    if (degrees_of_freedom % 2 == 0) {
+        // Q(k, x) = e^-x * sum_{j<k} x^j / j!
+        double term = std::exp(-x);
+        double p_value = term;
+        for (size_t j = 1; j < half_dof; ++j) {
+            term *= x / j;
+            p_value += term;
+        }
+        return p_value;
     }
     
-    // For other degrees of freedom, we would need to implement the incomplete gamma function
-    // This is a simplified approximation
-    return std::exp(-chi_square / 2.0);
+    // Q(k + 1/2, x) = erfc(sqrt(x)) + e^-x * sum_{j=1..k} x^(j-1/2) / Gamma(j+1/2)
+    double p_value = erfc(std::sqrt(x));
+    double term = 2.0 * std::exp(-x) * std::sqrt(x / kPi);
+    for (size_t j = 1; j <= half_dof; ++j) {
+        p_value += term;
+        term *= x / (j + 0.5);
+    }
+    return p_value;
 }
 
 double RandomnessTester::normal_cdf(double x) const {
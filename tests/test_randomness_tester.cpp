@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "../include/randomness_tester.h"
+
+class RandomnessTesterTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> random_bits(size_t count, uint64_t seed = 12345) {
+        std::mt19937_64 rng(seed);
+        std::vector<uint8_t> bits(count);
+        for (auto& bit : bits) {
+            bit = rng() & 1;
+        }
+        return bits;
+    }
+
+    // s[i] = s[i-a] ^ s[i-b] (b > a) seeded with a single one
+    static std::vector<uint8_t> lfsr_bits(size_t count, size_t a, size_t b) {
+        std::vector<uint8_t> bits(count, 0);
+        bits[0] = 1;
+        for (size_t i = b; i < count; ++i) {
+            bits[i] = bits[i - a] ^ bits[i - b];
+        }
+        return bits;
+    }
+
+    // Textbook Berlekamp-Massey, one coefficient per element
+    static size_t naive_linear_complexity(const std::vector<uint8_t>& s) {
+        const size_t n = s.size();
+        std::vector<uint8_t> c(n + 1, 0), b(n + 1, 0);
+        c[0] = b[0] = 1;
+        size_t L = 0;
+        size_t shift = 1;
+        for (size_t N = 0; N < n; ++N) {
+            uint8_t d = s[N];
+            for (size_t i = 1; i <= L; ++i) {
+                d ^= c[i] & s[N - i];
+            }
+            if (!d) {
+                ++shift;
+                continue;
+            }
+            std::vector<uint8_t> t = c;
+            for (size_t i = 0; i + shift <= n; ++i) {
+                c[i + shift] ^= b[i];
+            }
+            if (2 * L <= N) {
+                L = N + 1 - L;
+                b = t;
+                shift = 1;
+            } else {
+                ++shift;
+            }
+        }
+        return L;
+    }
+
+    // |X[k]|^2 by the O(n^2) DFT definition
+    static double naive_power(const std::vector<uint8_t>& bits, size_t k) {
+        const size_t n = bits.size();
+        const double step = 2.0 * 3.14159265358979323846 / n;
+        double re = 0.0, im = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            const double x = 2.0 * bits[j] - 1.0;
+            const double angle = step * ((j * k) % n);
+            re += x * std::cos(angle);
+            im -= x * std::sin(angle);
+        }
+        return re * re + im * im;
+    }
+
+    RandomnessTester tester;
+};
+
+TEST_F(RandomnessTesterTest, LinearComplexityOfPrimitiveLfsr) {
+    // Characteristic polynomials x^17 + x^14 + 1, x^31 + x^28 + 1 and
+    // x^89 + x^51 + 1 are primitive, so any nonzero seed gives L = degree
+    EXPECT_EQ(RandomnessTester::linear_complexity(lfsr_bits(200, 3, 17)), 17u);
+    EXPECT_EQ(RandomnessTester::linear_complexity(lfsr_bits(200, 3, 31)), 31u);
+    EXPECT_EQ(RandomnessTester::linear_complexity(lfsr_bits(400, 38, 89)), 89u);
+
+    std::vector<uint8_t> impulse(100, 0);
+    impulse.back() = 1;
+    EXPECT_EQ(RandomnessTester::linear_complexity(impulse), 100u);
+}
+
+TEST_F(RandomnessTesterTest, LinearComplexityMatchesNaiveAcrossWordBoundaries) {
+    for (size_t length : {63, 64, 65, 127, 128, 129, 500}) {
+        for (uint64_t seed = 1; seed <= 8; ++seed) {
+            const auto bits = random_bits(length, seed);
+            EXPECT_EQ(RandomnessTester::linear_complexity(bits), naive_linear_complexity(bits))
+                << "length " << length << ", seed " << seed;
+        }
+    }
+}
+
+TEST_F(RandomnessTesterTest, PowerSpectrumMatchesDirectDft) {
+    // 2^9 uses the plain bit reversal, 2^14 the tiled one with a radix-2
+    // pass above the cache block, 2^16 the fused radix-2^2 passes
+    for (size_t log_n : {9, 14, 16}) {
+        const size_t n = size_t{1} << log_n;
+        const auto bits = random_bits(n, log_n);
+        const auto power = RandomnessTester::power_spectrum(bits);
+        ASSERT_EQ(power.size(), n / 2);
+
+        const size_t step = std::max<size_t>(1, n / 2 / 257);
+        for (size_t k = 0; k < n / 2; k += (k < 4 ? 1 : step)) {
+            EXPECT_NEAR(power[k], naive_power(bits, k), 1e-9 * n)
+                << "n " << n << ", k " << k;
+        }
+    }
+
+    EXPECT_THROW(RandomnessTester::power_spectrum(random_bits(1000)), std::invalid_argument);
+}
+
+TEST_F(RandomnessTesterTest, ChiSquarePValue) {
+    // SP 800-22 section 2.10.4 example: chi-square 2.700348 with 6 degrees of freedom
+    EXPECT_NEAR(tester.calculate_p_value(2.700348, 6), 0.845406, 1e-6);
+    EXPECT_NEAR(tester.calculate_p_value(7.814728, 3), 0.05, 1e-6);
+    EXPECT_NEAR(tester.calculate_p_value(3.841459, 1), 0.05, 1e-6);
+}
+
+TEST_F(RandomnessTesterTest, LinearComplexityBlockSizeRange) {
+    RandomnessTestConfig config;
+    config.linear_complexity_block_size = 499;
+    EXPECT_THROW(RandomnessTester{config}, std::invalid_argument);
+    config.linear_complexity_block_size = 5001;
+    EXPECT_THROW(RandomnessTester{config}, std::invalid_argument);
+    config.linear_complexity_block_size = 5000;
+    EXPECT_NO_THROW(RandomnessTester{config});
+}
+
+TEST_F(RandomnessTesterTest, ShortInputsReturnZero) {
+    // Fewer than 200 linear complexity blocks, and a 512-bit spectral prefix
+    EXPECT_EQ(tester.linear_complexity_test(random_bits(99999)), 0.0);
+    EXPECT_EQ(tester.spectral_test(random_bits(1000)), 0.0);
+}
+
+TEST_F(RandomnessTesterTest, RandomSequencePassesStructureTests) {
+    auto bits = random_bits(1000000);
+    EXPECT_GE(tester.linear_complexity_test(bits), 0.01);
+    EXPECT_GE(tester.matrix_rank_test(bits), 0.01);
+    EXPECT_GE(tester.spectral_test(bits), 0.01);
+}
+
+TEST_F(RandomnessTesterTest, LfsrFailsLinearComplexityAndRank) {
+    std::vector<uint8_t> bits = random_bits(1000000);
+    for (size_t i = 31; i < bits.size(); ++i) {
+        bits[i] = bits[i - 3] ^ bits[i - 31];
+    }
+    EXPECT_LT(tester.linear_complexity_test(bits), 0.01);
+    EXPECT_LT(tester.matrix_rank_test(bits), 0.01);
+}
+
+TEST_F(RandomnessTesterTest, PeriodicSequenceFailsSpectralTest) {
+    std::vector<uint8_t> bits = random_bits(1 << 20);
+    for (size_t i = 700; i < bits.size(); ++i) {
+        bits[i] = bits[i - 700];
+    }
+    EXPECT_LT(tester.spectral_test(bits), 0.01);
+}